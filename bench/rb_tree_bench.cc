@@ -0,0 +1,74 @@
+#include <chrono>   // For std::chrono
+#include <cstddef>  // For std::size_t
+#include <cstdio>   // For std::printf
+#include <vector>   // For std::vector
+
+#include "rb_tree.h"  // For cxx::rb_tree
+
+// Micro-benchmarks for building and copying a cxx::rb_tree.
+// Each O(n) path is timed next to the way the same work was done before it
+// existed: building by inserting every value, and copying by re-inserting
+// every value of the source.
+
+namespace {
+
+  constexpr std::size_t element_count = 1 << 20;
+
+  using tree = cxx::rb_tree<int>;
+
+  template <typename Function>
+  double time_ns(Function function) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto stop  = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count();
+  }
+
+  volatile std::size_t sink; ///< Keeps results observable so the work is not optimised away.
+
+  void bench_round(const std::vector<int>& sorted) {
+    tree inserted;
+    const double insert_ns = time_ns([&] {
+      for ( int v : sorted ) {
+        inserted.insert(v);
+      }
+    });
+
+    tree loaded;
+    const double load_ns = time_ns([&] { loaded.assign_sorted(sorted.begin(), sorted.end()); });
+
+    std::size_t copied = 0;
+    const double reinsert_ns = time_ns([&] {
+      tree copy;
+      loaded.scan([&copy](int v) { copy.insert(v); });
+      copied += copy.size();
+    });
+
+    const double clone_ns = time_ns([&] {
+      const tree copy { loaded };
+      copied += copy.size();
+    });
+
+    sink = copied + inserted.size();
+    const double n = static_cast<double>(sorted.size());
+    std::printf("build: insert %6.1f ns/op | assign_sorted %5.1f ns/op | copy: re-insert %6.1f ns/op | clone %5.1f ns/op\n",
+                insert_ns / n, load_ns / n, reinsert_ns / n, clone_ns / n);
+  }
+
+} // namespace
+
+int main() {
+  std::vector<int> sorted;
+  sorted.reserve(element_count);
+  for ( std::size_t i = 0; i < element_count; ++i ) {
+    sorted.push_back(static_cast<int>(i * 2));
+  }
+
+  std::printf("%zu elements\n", element_count);
+  // The first round also pays for faulting in fresh pages, compare the later ones
+  for ( int round = 1; round <= 3; ++round ) {
+    std::printf("round %d: ", round);
+    bench_round(sorted);
+  }
+  return 0;
+}
@@ -0,0 +1,98 @@
+#include <chrono>   // For std::chrono
+#include <cstddef>  // For std::size_t
+#include <cstdio>   // For std::printf
+#include <random>   // For std::mt19937
+#include <vector>   // For std::vector
+
+#include "rb_tree.h"            // For cxx::rb_tree
+#include "rb_tree_hot_cache.h"  // For cxx::rb_tree_direct_mapped_cache, cxx::rb_tree_no_cache
+
+// Skewed lookups against a large int tree, with and without the hot-key cache.
+// 80% of the lookups go to the hottest 1% of the keys, the rest are uniform.
+// Keys have a power-of-two stride, which the identity std::hash<int> maps to
+// hashes that only differ in their high bits.
+
+namespace {
+
+  constexpr std::size_t element_count = 1 << 20;
+  constexpr std::size_t hot_count     = element_count / 100;
+  constexpr std::size_t lookup_count  = 1 << 22;
+  constexpr int         key_stride    = 16;
+
+  template <typename Function>
+  double time_ns(Function function) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto stop  = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count();
+  }
+
+  volatile std::size_t sink; ///< Keeps results observable so the work is not optimised away.
+
+  template <typename Tree>
+  std::size_t run_lookups(const Tree& tree, const std::vector<int>& lookups) {
+    std::size_t found = 0;
+    for ( int v : lookups ) {
+      found += tree.search(v) != nullptr;
+    }
+    return found;
+  }
+
+  /// @brief Times lookups on a tree using CachePolicy, and reports the hit rate of
+  ///        the same cache with counting enabled, measured in a separate untimed pass.
+  template <typename CachePolicy, typename CountingPolicy>
+  void bench_cache(const char* label, const std::vector<int>& keys, const std::vector<int>& lookups) {
+    cxx::rb_tree<int, std::less<int>, CachePolicy> tree;
+    tree.assign_sorted(keys.begin(), keys.end());
+    run_lookups(tree, lookups); // Warm the cache and the touched nodes
+    const double search_ns = time_ns([&] { sink = run_lookups(tree, lookups); });
+
+    cxx::rb_tree<int, std::less<int>, CountingPolicy> counted;
+    counted.assign_sorted(keys.begin(), keys.end());
+    run_lookups(counted, lookups);
+    const double total = static_cast<double>(counted.cache().hits() + counted.cache().misses());
+    const double rate  = total == 0 ? 0.0 : 100.0 * static_cast<double>(counted.cache().hits()) / total;
+
+    std::printf("%-22s search %6.1f ns/op | hit rate %5.1f%%\n", label, search_ns / lookups.size(), rate);
+  }
+
+} // namespace
+
+int main() {
+  std::vector<int> keys;
+  keys.reserve(element_count);
+  for ( std::size_t i = 0; i < element_count; ++i ) {
+    keys.push_back(static_cast<int>(i) * key_stride);
+  }
+
+  std::mt19937 rng { 42 };
+  std::uniform_int_distribution<std::size_t> any_index { 0, element_count - 1 };
+  std::vector<int> hot;
+  hot.reserve(hot_count);
+  for ( std::size_t i = 0; i < hot_count; ++i ) {
+    hot.push_back(keys[any_index(rng)]);
+  }
+
+  std::uniform_int_distribution<std::size_t> hot_index { 0, hot_count - 1 };
+  std::uniform_int_distribution<int>         percent   { 0, 99 };
+  std::vector<int> lookups;
+  lookups.reserve(lookup_count);
+  for ( std::size_t i = 0; i < lookup_count; ++i ) {
+    lookups.push_back(percent(rng) < 80 ? hot[hot_index(rng)] : keys[any_index(rng)]);
+  }
+
+  using no_cache        = cxx::rb_tree_no_cache<int>;
+  using default_cache   = cxx::rb_tree_direct_mapped_cache<int>;
+  using small_cache     = cxx::rb_tree_direct_mapped_cache<int, 64>;
+  using counted_default = cxx::rb_tree_direct_mapped_cache<int, 16384, std::hash<int>, true>;
+  using counted_small   = cxx::rb_tree_direct_mapped_cache<int, 64, std::hash<int>, true>;
+
+  std::printf("%zu elements, %zu hot, %zu lookups (80%% hot)\n", element_count, hot_count, lookup_count);
+  for ( int round = 1; round <= 3; ++round ) {
+    std::printf("round %d\n", round);
+    bench_cache<no_cache, no_cache>("no cache", keys, lookups);
+    bench_cache<default_cache, counted_default>("cache, 16384 slots", keys, lookups);
+    bench_cache<small_cache, counted_small>("cache, 64 slots", keys, lookups);
+  }
+  return 0;
+}
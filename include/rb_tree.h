@@ -0,0 +1 @@
+../src/rb_tree/rb_tree.h
\ No newline at end of file
@@ -0,0 +1 @@
+../src/rb_tree/node/rb_tree_base_node.h
\ No newline at end of file
@@ -0,0 +1 @@
+../src/rb_tree/cache/rb_tree_hot_cache.h
\ No newline at end of file
@@ -0,0 +1 @@
+../src/rb_tree/iterator/rb_tree_range.h
\ No newline at end of file
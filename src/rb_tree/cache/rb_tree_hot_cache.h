@@ -0,0 +1,230 @@
+#ifndef   __RB_TREE_HOT_CACHE__
+# define  __RB_TREE_HOT_CACHE__
+
+# include <atomic>                   // For std::atomic, std::memory_order_relaxed
+# include <cstdint>                  // For std::uint64_t
+# include <memory>                   // For std::unique_ptr, std::make_unique
+# include <bits/c++config.h>         // For std::size_t
+# include <bits/functional_hash.h>   // For std::hash
+
+# include "rb_tree_node.h"  // For cxx::rb_tree_node
+
+namespace cxx {
+
+  /// @brief Size in bytes of a cache line, used to align the hot-key cache slots.
+  inline constexpr std::size_t rb_tree_cache_line_size = 64;
+
+  /// @struct rb_tree_no_cache
+  /// @brief Hot-key cache policy that disables caching.
+  ///
+  /// Every operation is an empty constexpr function, so a tree using this policy
+  /// compiles down to the plain lookup path.
+  ///
+  /// @tparam ValueType The type of value stored in the tree.
+  template <typename ValueType>
+  struct rb_tree_no_cache
+  {
+    using node_ptr  = rb_tree_node<ValueType>*;
+    using size_type = std::size_t;
+
+    /// @brief Never finds anything.
+    /// @return Always nullptr.
+    template <typename Equivalent>
+    constexpr node_ptr find(const ValueType&, Equivalent) const noexcept {
+      return nullptr;
+    }
+
+    /// @brief Does nothing.
+    constexpr void remember(const ValueType&, node_ptr) noexcept { }
+
+    /// @brief Does nothing.
+    constexpr void forget(const ValueType&) noexcept { }
+
+    /// @brief Does nothing.
+    constexpr void clear() noexcept { }
+
+    /// @brief Returns the number of cache hits, always 0.
+    [[nodiscard]]
+    constexpr size_type hits() const noexcept {
+      return 0;
+    }
+
+    /// @brief Returns the number of cache misses, always 0.
+    [[nodiscard]]
+    constexpr size_type misses() const noexcept {
+      return 0;
+    }
+  };
+
+  /// @class rb_tree_direct_mapped_cache
+  /// @brief Direct-mapped hot-key cache placed in front of the tree lookups.
+  ///
+  /// Maps the hash of a value to the node holding it, so repeated lookups of hot
+  /// keys skip the descent from the root. Each slot keeps the full hash next to
+  /// the node pointer and the slots are packed into cache-line aligned storage.
+  ///
+  /// The slot index is taken from the high bits of the hash multiplied by a
+  /// large odd constant, so hashes that only differ in their high bits (such as
+  /// the identity std::hash of keys with a power-of-two stride) still spread
+  /// over all slots.
+  ///
+  /// Each slot carries a reference bit, set when a lookup hits it. A miss
+  /// mapping to a referenced slot only clears the bit; the resident is replaced
+  /// by the next miss if it has not been hit again in between. A single cold
+  /// lookup therefore cannot evict a hot key.
+  ///
+  /// The default of 16384 slots (384 KiB on the heap with 64-bit pointers)
+  /// suits hot sets of up to about ten thousand keys. Slots should be about
+  /// twice the expected number of hot keys: an undersized cache keeps
+  /// missing and only adds overhead to every lookup.
+  ///
+  /// The cache only stores pointers; the owning tree is responsible for keeping
+  /// it coherent by calling `forget` before a node is destroyed and `clear` when
+  /// all nodes are released.
+  ///
+  /// Lookups on a const tree write to the cache, so slots are relaxed atomics:
+  /// concurrent readers of an unchanging tree stay race-free. A reader may
+  /// observe the hash of one write and the node of another, which `find`
+  /// tolerates because the node is always confirmed with `equivalent`.
+  ///
+  /// Hit and miss counting is off by default. Every counted lookup increments a
+  /// shared atomic, which makes concurrent readers contend on its cache line, so
+  /// CountLookups is meant for tuning the cache rather than for production use.
+  ///
+  /// @tparam ValueType The type of value stored in the tree.
+  /// @tparam Slots Number of slots, must be a power of two.
+  /// @tparam Hash Hash functor for ValueType, defaults to std::hash<ValueType>.
+  /// @tparam CountLookups Whether `hits` and `misses` are counted, defaults to false.
+  template <typename ValueType, std::size_t Slots = 16384, typename Hash = std::hash<ValueType>,
+            bool CountLookups = false>
+  class rb_tree_direct_mapped_cache
+  {
+    static_assert(Slots != 0 && (Slots & (Slots - 1)) == 0, "Slots must be a power of two");
+
+  public:
+    using node_ptr  = rb_tree_node<ValueType>*;
+    using size_type = std::size_t;
+    using hasher    = Hash;
+
+  public:
+    /// @brief Constructs an empty cache with an optional hash functor.
+    explicit rb_tree_direct_mapped_cache(const hasher& hash = hasher())
+      : _table { std::make_unique<table>() }, _hash { hash }
+    { }
+
+    /// @brief Looks up the node cached for `value`.
+    /// @param value The value to look up.
+    /// @param equivalent Predicate confirming that a cached node holds `value`.
+    /// @return Pointer to the cached node, or nullptr on a miss.
+    template <typename Equivalent>
+    node_ptr find(const ValueType& value, Equivalent equivalent) noexcept {
+      const size_type h = _hash(value);
+      slot&           s = _slot_of(h);
+      const node_ptr  n = s._node.load(std::memory_order_relaxed);
+      if ( n != nullptr && s._hash.load(std::memory_order_relaxed) == h && equivalent(n) ) {
+        // Only the first hit since the last miss writes, hot slots stay shared between readers
+        if ( !s._referenced.load(std::memory_order_relaxed) ) {
+          s._referenced.store(true, std::memory_order_relaxed);
+        }
+        if constexpr ( CountLookups ) {
+          _hits.fetch_add(1, std::memory_order_relaxed);
+        }
+        return n;
+      }
+
+      if constexpr ( CountLookups ) {
+        _misses.fetch_add(1, std::memory_order_relaxed);
+      }
+      return nullptr;
+    }
+
+    /// @brief Caches `n` as the node holding `value`, unless the slot owner was hit since the last miss.
+    /// In that case the owner stays and loses its reference bit.
+    void remember(const ValueType& value, node_ptr n) noexcept {
+      const size_type h = _hash(value);
+      slot&           s = _slot_of(h);
+      if ( s._referenced.load(std::memory_order_relaxed) && s._node.load(std::memory_order_relaxed) != nullptr ) {
+        s._referenced.store(false, std::memory_order_relaxed); // Second chance for the owner
+        return;
+      }
+
+      s._hash.store(h, std::memory_order_relaxed);
+      s._node.store(n, std::memory_order_relaxed);
+      s._referenced.store(false, std::memory_order_relaxed);
+    }
+
+    /// @brief Drops the slot that may refer to the node holding `value`.
+    void forget(const ValueType& value) noexcept {
+      const size_type h = _hash(value);
+      slot&           s = _slot_of(h);
+      if ( s._hash.load(std::memory_order_relaxed) == h ) {
+        s._node.store(nullptr, std::memory_order_relaxed);
+        s._referenced.store(false, std::memory_order_relaxed);
+      }
+    }
+
+    /// @brief Drops every cached node. Hit and miss counters are preserved.
+    void clear() noexcept {
+      for ( slot& s : _table->_slots ) {
+        s._node.store(nullptr, std::memory_order_relaxed);
+        s._referenced.store(false, std::memory_order_relaxed);
+      }
+    }
+
+    /// @brief Returns the number of lookups answered by the cache, always 0 unless CountLookups.
+    [[nodiscard]]
+    size_type hits() const noexcept {
+      return _hits.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the number of lookups that fell through to the tree, always 0 unless CountLookups.
+    [[nodiscard]]
+    size_type misses() const noexcept {
+      return _misses.load(std::memory_order_relaxed);
+    }
+
+  private:
+    /// @brief One cache entry: the full hash of the value and the node holding it.
+    struct slot
+    {
+      std::atomic<size_type> _hash       { 0 };       ///< Hash of the cached value.
+      std::atomic<node_ptr>  _node       { nullptr }; ///< Cached node, nullptr when the slot is empty.
+      std::atomic<bool>      _referenced { false };   ///< Set by a hit, cleared by a miss sparing the owner.
+    };
+
+    /// @brief Slot storage, cache-line aligned.
+    struct alignas(rb_tree_cache_line_size) table
+    {
+      slot _slots[Slots];
+    };
+
+    /// @brief Number of hash bits used to index the slots.
+    static constexpr unsigned index_bits = [] {
+      unsigned bits = 0;
+      while ( (std::size_t { 1 } << bits) < Slots ) {
+        ++bits;
+      }
+      return bits;
+    }();
+
+  private:
+    /// @brief Returns the slot for hash `h`, indexed by the high bits of a Fibonacci hash.
+    slot& _slot_of(size_type h) const noexcept {
+      if constexpr ( index_bits == 0 ) {
+        return _table->_slots[0];
+      } else {
+        const std::uint64_t mixed = static_cast<std::uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+        return _table->_slots[static_cast<size_type>(mixed >> (64 - index_bits))];
+      }
+    }
+
+  private:
+    std::unique_ptr<table> _table;        ///< Slot storage, on the heap so a large cache does not bloat the tree.
+    std::atomic<size_type> _hits   { 0 }; ///< Number of cache hits, only updated with CountLookups.
+    std::atomic<size_type> _misses { 0 }; ///< Number of cache misses, only updated with CountLookups.
+    hasher                 _hash;         ///< Hash functor for values.
+  };
+
+} // namespace cxx
+
+#endif // __RB_TREE_HOT_CACHE__
@@ -46,14 +46,14 @@ namespace cxx {
     /// Returns a reference to the value stored in the node pointed to by the iterator.
     /// @return Reference to the value.
     constexpr reference operator*() const noexcept {
-      return _node->m_valueField;
+      return _node->_value;
     }
 
     /// @brief Arrow operator.
     /// Returns a pointer to the value stored in the node pointed to by the iterator.
     /// @return Pointer to the value.
     constexpr pointer operator->() const noexcept {
-      return &_node->m_valueField;
+      return &_node->_value;
     }
 
     /// @brief Pre-increment operator.
@@ -85,7 +85,7 @@ namespace cxx {
     /// Moves the iterator to the previous node in the tree and returns a copy of the original iterator.
     /// @return Copy of the original iterator.
     rb_tree_iterator operator--(int) {
-      constexpr rb_tree_iterator tmp = *this;
+      const rb_tree_iterator tmp = *this;
       --(*this);
       return tmp;
     }
@@ -157,14 +157,14 @@ namespace cxx {
     /// Returns a const reference to the value pointed to by the iterator.
     /// @return Const reference to the value.
     reference operator*() const noexcept {
-      return _node->value;
+      return _node->_value;
     }
 
     /// @brief Arrow operator.
     /// Returns a const pointer to the value pointed to by the iterator.
     /// @return Const pointer to the value.
     pointer operator->() const noexcept {
-      return &_node->value;
+      return &_node->_value;
     }
 
     /// @brief Pre-increment operator.
@@ -179,7 +179,7 @@ namespace cxx {
     /// Moves the iterator to the next node in the tree.
     /// @return Value of the iterator before incrementing.
     rb_tree_const_iterator operator++(int) noexcept {
-      constexpr rb_tree_const_iterator tmp = *this;
+      const rb_tree_const_iterator tmp = *this;
       ++(*this);
       return tmp;
     }
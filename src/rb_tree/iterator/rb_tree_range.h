@@ -0,0 +1,222 @@
+#ifndef   __RB_TREE_RANGE__
+# define  __RB_TREE_RANGE__
+
+# include <climits>                         // For CHAR_BIT
+# include <optional>                        // For std::optional
+# include <bits/c++config.h>                // For std::size_t, std::ptrdiff_t
+# include <bits/stl_iterator_base_types.h>  // For std::input_iterator_tag
+
+# include "rb_tree_node.h"  // For cxx::rb_tree_node
+
+namespace cxx {
+
+  /// @brief In-order cursor over the values of a tree, optionally within [lo, hi).
+  ///
+  /// Unlike rb_tree_iterator, which climbs parent pointers in `_next`, the cursor
+  /// keeps the pending ancestors on an explicit stack, so every step only reads
+  /// nodes it is about to visit. The right child of each stacked node is
+  /// prefetched when the node is pushed, ahead of the step that descends into it.
+  ///
+  /// The stack holds at most one node per level. A Red-Black Tree storing n
+  /// nodes is at most 2 * log2(n + 1) levels deep, which bounds the stack size.
+  ///
+  /// @tparam ValueType Type of values stored in the tree.
+  /// @tparam Compare Comparison functor used to order elements.
+  template <typename ValueType, typename Compare>
+  class rb_tree_cursor
+  {
+    using node     = rb_tree_node<ValueType>;
+    using base     = typename node::base;
+    using base_ptr = const base*;
+    using node_ptr = const node*;
+
+  public:
+    using size_type = std::size_t;
+
+    /// @brief Maximum depth of a Red-Black Tree whose size fits in size_type.
+    static constexpr size_type max_depth = 2 * sizeof(size_type) * CHAR_BIT;
+
+  public:
+    /// @brief Constructs a cursor positioned on the smallest value of the tree, without bounds.
+    /// @param root Root of the tree.
+    /// @param nil  Sentinel node of the tree.
+    /// @param comp Comparison functor of the tree.
+    rb_tree_cursor(base_ptr root, base_ptr nil, const Compare& comp)
+      : _nil { nil }, _hi { nullptr }, _comp { comp }
+    {
+      _push_left_spine(root);
+    }
+
+    /// @brief Constructs a cursor positioned on the first value not less than `lo`.
+    /// @param root Root of the tree.
+    /// @param nil  Sentinel node of the tree.
+    /// @param lo   Inclusive lower bound.
+    /// @param hi   Exclusive upper bound.
+    /// @param comp Comparison functor of the tree.
+    rb_tree_cursor(base_ptr root, base_ptr nil, const ValueType& lo, const ValueType& hi, const Compare& comp)
+      : _nil { nil }, _hi { &hi }, _comp { comp }
+    {
+      // Keep every ancestor at or after `lo`, the deepest one is the lower bound
+      while ( root != _nil ) {
+        if ( _comp(static_cast<node_ptr>(root)->_value, lo) ) {
+          root = root->_right;
+        } else {
+          _push(root);
+          root = root->_left;
+        }
+      }
+    }
+
+    /// @brief Returns the next node in the range.
+    /// @return Pointer to the node, nullptr once the range is exhausted.
+    node_ptr next() noexcept {
+      if ( _depth == 0 ) {
+        return nullptr;
+      }
+
+      const node_ptr current = static_cast<node_ptr>(_stack[--_depth]);
+      if ( _hi != nullptr && !_comp(current->_value, *_hi) ) {
+        _depth = 0; // Past the upper bound, nothing left to visit
+        return nullptr;
+      }
+
+      _push_left_spine(current->_right);
+      return current;
+    }
+
+  private:
+    /// @brief Pushes a node and prefetches the subtree visited right after it.
+    void _push(base_ptr n) noexcept {
+      __builtin_prefetch(n->_right);
+      _stack[_depth++] = n;
+    }
+
+    /// @brief Pushes `n` and all its left descendants.
+    void _push_left_spine(base_ptr n) noexcept {
+      while ( n != _nil ) {
+        _push(n);
+        n = n->_left;
+      }
+    }
+
+  private:
+    base_ptr         _stack[max_depth];  ///< Ancestors still to be visited, in visiting order from the top.
+    size_type        _depth { 0 };       ///< Number of nodes on the stack.
+    base_ptr         _nil;               ///< Sentinel node of the tree.
+    const ValueType* _hi;                ///< Exclusive upper bound of the range, nullptr if unbounded.
+    Compare          _comp;              ///< Comparison functor of the tree.
+  };
+
+} // namespace cxx
+
+namespace cxx {
+
+  /// @brief Single-pass view over the values of a tree within [lo, hi).
+  ///
+  /// The view owns copies of its bounds and the rb_tree_cursor walking them;
+  /// iterators only point at that cursor. `begin()` restarts the walk, so the
+  /// view must outlive its iterators and be iterated by one consumer at a time.
+  ///
+  /// @tparam ValueType Type of values stored in the tree.
+  /// @tparam Compare Comparison functor used to order elements.
+  template <typename ValueType, typename Compare>
+  class rb_tree_range
+  {
+    using cursor   = rb_tree_cursor<ValueType, Compare>;
+    using node     = rb_tree_node<ValueType>;
+    using base_ptr = const typename node::base*;
+    using node_ptr = const node*;
+
+  public:
+    /// @brief Input iterator over the values of the range.
+    /// A default-constructed iterator is the end iterator.
+    struct iterator
+    {
+      using value_type = ValueType;
+      using pointer    = const ValueType*;
+      using reference  = const ValueType&;
+
+      using iterator_category = std::input_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+
+      /// @brief Dereference operator.
+      /// @return Const reference to the current value.
+      reference operator*() const noexcept {
+        return _node->_value;
+      }
+
+      /// @brief Arrow operator.
+      /// @return Const pointer to the current value.
+      pointer operator->() const noexcept {
+        return &_node->_value;
+      }
+
+      /// @brief Pre-increment operator.
+      /// Moves the iterator to the next value in the range.
+      iterator& operator++() noexcept {
+        _node = _cursor->next();
+        return *this;
+      }
+
+      /// @brief Post-increment operator.
+      /// Moves the iterator to the next value in the range.
+      /// @return Copy of the iterator before incrementing, valid for dereferencing only.
+      iterator operator++(int) noexcept {
+        const iterator tmp = *this;
+        ++(*this);
+        return tmp;
+      }
+
+      /// @brief Equality operator.
+      /// Checks if two iterators point to the same node.
+      bool operator==(const iterator& other) const noexcept {
+        return _node == other._node;
+      }
+
+      /// @brief Inequality operator.
+      /// Checks if two iterators point to different nodes.
+      bool operator!=(const iterator& other) const noexcept {
+        return _node != other._node;
+      }
+
+      cursor*  _cursor { nullptr }; ///< Cursor owned by the view, producing the following values.
+      node_ptr _node   { nullptr }; ///< Current node, nullptr for the end iterator.
+    };
+
+  public:
+    /// @brief Constructs a view over [lo, hi) of the tree rooted at `root`.
+    rb_tree_range(base_ptr root, base_ptr nil, const ValueType& lo, const ValueType& hi, const Compare& comp)
+      : _root { root }, _nil { nil }, _lo { lo }, _hi { hi }, _comp { comp }
+    { }
+
+    /// @brief Copy constructor. The copy starts without a walk in progress.
+    rb_tree_range(const rb_tree_range& other)
+      : _root { other._root }, _nil { other._nil }, _lo { other._lo }, _hi { other._hi }, _comp { other._comp }
+    { }
+
+    rb_tree_range& operator=(const rb_tree_range&) = delete;
+
+    /// @brief Restarts the walk and returns an iterator to the first value of the range.
+    iterator begin() {
+      // The cursor refers to `_hi`, which lives as long as the view
+      _cursor.emplace(_root, _nil, _lo, _hi, _comp);
+      return iterator { &*_cursor, _cursor->next() };
+    }
+
+    /// @brief Returns the past-the-end iterator of the range.
+    iterator end() const noexcept {
+      return iterator {};
+    }
+
+  private:
+    base_ptr              _root;   ///< Root of the tree.
+    base_ptr              _nil;    ///< Sentinel node of the tree.
+    ValueType             _lo;     ///< Inclusive lower bound.
+    ValueType             _hi;     ///< Exclusive upper bound.
+    Compare               _comp;   ///< Comparison functor of the tree.
+    std::optional<cursor> _cursor; ///< Walk in progress, engaged by `begin()`.
+  };
+
+} // namespace cxx
+
+#endif // __RB_TREE_RANGE__
@@ -7,7 +7,7 @@ namespace cxx {
 
   // Finds the minimum node in the Red-Black Tree rooted at _x.
   // Traverses left children until reaching the leftmost node or the nil sentinel.
-  constexpr rb_tree_base_node *
+  rb_tree_base_node *
   rb_tree_base_node::_minimum(base_ptr _x, const base_ptr _nil) noexcept
   {
     if ( _x == _nil ) {
@@ -23,7 +23,7 @@ namespace cxx {
 
   // Finds the maximum node in the Red-Black Tree rooted at _x.
   // Traverses right children until reaching the rightmost node or the nil sentinel.
-  constexpr rb_tree_base_node *
+  rb_tree_base_node *
   rb_tree_base_node::_maximum(base_ptr _x, const base_ptr _nil) noexcept
   {
     if ( _x == _nil ) {
@@ -47,7 +47,7 @@ namespace cxx {
   // Finds the in-order successor of node _x in the Red-Black Tree.
   // If _x has a right child, the successor is the minimum node in the right subtree.
   // Otherwise, traverse up the tree until finding a node that is a left child of its parent.
-  constexpr rb_tree_base_node *
+  rb_tree_base_node *
   rb_tree_base_node::_next(base_ptr _x, const base_ptr _nil) noexcept
   {
     if ( _x == _nil ) {
@@ -70,7 +70,7 @@ namespace cxx {
   // Finds the in-order predecessor of node _x in the Red-Black Tree.
   // If _x has a left child, the predecessor is the maximum node in the left subtree.
   // Otherwise, traverse up the tree until finding a node that is a right child of its parent.
-  constexpr rb_tree_base_node *
+  rb_tree_base_node *
   rb_tree_base_node::_prev(base_ptr _x, const base_ptr _nil) noexcept
   {
     if ( _x == _nil ) {
@@ -91,3 +91,111 @@ namespace cxx {
   }
 
 } // namespace cxx
+
+// Implementation of the rotations and of the rebalancing done after an insertion.
+// Rotations keep the in-order sequence intact and only relink three nodes; the
+// sentinel's links are never written.
+namespace cxx {
+
+  // Rotates left around _x: its right child _y becomes the root of the subtree,
+  // _x becomes the left child of _y and takes over _y's former left subtree.
+  void
+  rb_tree_base_node::_rotate_left(base_ptr _x, base_ptr& _root, const base_ptr _nil) noexcept
+  {
+    base_ptr _y = _x->_right;
+    _x->_right = _y->_left;
+    if ( _y->_left != _nil ) {
+      _y->_left->_parent = _x;
+    }
+
+    _y->_parent = _x->_parent;
+    if ( _x->_parent == _nil ) {
+      _root = _y;
+    } else if ( _x == _x->_parent->_left ) {
+      _x->_parent->_left = _y;
+    } else {
+      _x->_parent->_right = _y;
+    }
+
+    _y->_left   = _x;
+    _x->_parent = _y;
+  }
+
+  // Rotates right around _x: mirror image of _rotate_left.
+  void
+  rb_tree_base_node::_rotate_right(base_ptr _x, base_ptr& _root, const base_ptr _nil) noexcept
+  {
+    base_ptr _y = _x->_left;
+    _x->_left = _y->_right;
+    if ( _y->_right != _nil ) {
+      _y->_right->_parent = _x;
+    }
+
+    _y->_parent = _x->_parent;
+    if ( _x->_parent == _nil ) {
+      _root = _y;
+    } else if ( _x == _x->_parent->_right ) {
+      _x->_parent->_right = _y;
+    } else {
+      _x->_parent->_left = _y;
+    }
+
+    _y->_right  = _x;
+    _x->_parent = _y;
+  }
+
+  // Walks up from the red node _x while its parent is red as well. A red uncle is
+  // fixed by recoloring and moving the problem two levels up; a black uncle is
+  // fixed by at most two rotations. The sentinel is black, so the loop stops at the root.
+  void
+  rb_tree_base_node::_insert_fixup(base_ptr _x, base_ptr& _root, const base_ptr _nil) noexcept
+  {
+    while ( _x->_parent->_color == color::Red ) {
+      base_ptr _parent = _x->_parent;
+      base_ptr _grand  = _parent->_parent;
+
+      if ( _parent == _grand->_left ) {
+        base_ptr _uncle = _grand->_right;
+        if ( _uncle->_color == color::Red ) {
+          _parent->_color = color::Black;
+          _uncle->_color  = color::Black;
+          _grand->_color  = color::Red;
+          _x = _grand;
+          continue;
+        }
+
+        if ( _x == _parent->_right ) {
+          _x = _parent;
+          _rotate_left(_x, _root, _nil);
+          _parent = _x->_parent;
+        }
+
+        _parent->_color = color::Black;
+        _grand->_color  = color::Red;
+        _rotate_right(_grand, _root, _nil);
+      } else {
+        base_ptr _uncle = _grand->_left;
+        if ( _uncle->_color == color::Red ) {
+          _parent->_color = color::Black;
+          _uncle->_color  = color::Black;
+          _grand->_color  = color::Red;
+          _x = _grand;
+          continue;
+        }
+
+        if ( _x == _parent->_left ) {
+          _x = _parent;
+          _rotate_right(_x, _root, _nil);
+          _parent = _x->_parent;
+        }
+
+        _parent->_color = color::Black;
+        _grand->_color  = color::Red;
+        _rotate_left(_grand, _root, _nil);
+      }
+    }
+
+    _root->_color = color::Black;
+  }
+
+} // namespace cxx
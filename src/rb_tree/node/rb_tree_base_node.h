@@ -33,6 +33,8 @@ namespace cxx {
   ///   - _maximum: Returns the maximum node in the subtree rooted at a given node.
   ///   - _next: Returns the next node in the in-order traversal.
   ///   - _prev: Returns the previous node in the in-order traversal.
+  ///   - _rotate_left, _rotate_right: Rotate a subtree around a node.
+  ///   - _insert_fixup: Restores the Red-Black properties after an insertion.
   ///
   /// All functions take a sentinel node (_nil) representing the leaf/null node in the Red-Black Tree.
   struct rb_tree_base_node
@@ -49,25 +51,43 @@ namespace cxx {
     /// @param _x Pointer to the node from which to find the minimum.
     /// @param _nil Sentinel node representing leaf/null in the Red-Black Tree.
     /// @return Pointer to the minimum node in the subtree rooted at `_x`.
-    static constexpr base_ptr _minimum(base_ptr _x, const base_ptr _nil) noexcept;
+    static base_ptr _minimum(base_ptr _x, const base_ptr _nil) noexcept;
 
     /// @brief Maximum node in the subtree.
     /// @param _x Pointer to the node from which to find the maximum.
     /// @param _nil Sentinel node representing leaf/null in the Red-Black Tree.
     /// @return Pointer to the maximum node in the subtree rooted at `_x`.
-    static constexpr base_ptr _maximum(base_ptr _x, const base_ptr _nil) noexcept;
+    static base_ptr _maximum(base_ptr _x, const base_ptr _nil) noexcept;
 
     /// @brief Get the next node in the in-order traversal.
     /// @param _x   Pointer to the current node.
     /// @param _nil Sentinel node representing leaf/null in the Red-Black Tree.
     /// @return Pointer to the next node in the in-order traversal.
-    static constexpr base_ptr _next(base_ptr _x, const base_ptr _nil) noexcept;
+    static base_ptr _next(base_ptr _x, const base_ptr _nil) noexcept;
 
     /// @brief Get the previous node in the in-order traversal.
     /// @param _x Pointer to the current node.
     /// @param _nil Sentinel node representing leaf/null in the Red-Black Tree.
     /// @return Pointer to the previous node in the in-order traversal.
-    static constexpr base_ptr _prev(base_ptr _x, const base_ptr _nil) noexcept;
+    static base_ptr _prev(base_ptr _x, const base_ptr _nil) noexcept;
+
+    /// @brief Rotate the subtree rooted at `_x` to the left, its right child takes its place.
+    /// @param _x    Pointer to the node to rotate around, its right child must not be `_nil`.
+    /// @param _root Root of the tree, updated if `_x` was the root.
+    /// @param _nil  Sentinel node representing leaf/null in the Red-Black Tree.
+    static void _rotate_left(base_ptr _x, base_ptr& _root, const base_ptr _nil) noexcept;
+
+    /// @brief Rotate the subtree rooted at `_x` to the right, its left child takes its place.
+    /// @param _x    Pointer to the node to rotate around, its left child must not be `_nil`.
+    /// @param _root Root of the tree, updated if `_x` was the root.
+    /// @param _nil  Sentinel node representing leaf/null in the Red-Black Tree.
+    static void _rotate_right(base_ptr _x, base_ptr& _root, const base_ptr _nil) noexcept;
+
+    /// @brief Restore the Red-Black properties after inserting the red node `_x`.
+    /// @param _x    Pointer to the freshly inserted node.
+    /// @param _root Root of the tree, updated if the rebalancing changes it.
+    /// @param _nil  Sentinel node representing leaf/null in the Red-Black Tree.
+    static void _insert_fixup(base_ptr _x, base_ptr& _root, const base_ptr _nil) noexcept;
 
   };
 } // namespace cxx
@@ -9,6 +9,8 @@ namespace cxx {
   /// @brief Node structure for Red-Black Tree, templated by value type.
   ///
   /// Inherits from rb_tree_base_node and stores a value of type ValueType.
+  /// Values of up to 4 bytes are laid out in the base node's tail padding, so
+  /// such a node takes 32 bytes, links and value included.
   ///
   /// @tparam ValueType The type of value stored in the node.
   template <typename ValueType>
@@ -31,9 +33,9 @@ namespace cxx {
     /// @param value The value to store in the new node.
     /// @return Pointer to the newly created node.
     [[nodiscard]]
-    static node_ptr create_node(const value_type& value, const base_ptr nil) noexcept {
+    static node_ptr create_node(const ValueType& value, const base_ptr nil) {
       // Allocate a new node holding `value`.
-      node_ptr new_node = new node(value);
+      node_ptr new_node = new rb_tree_node(value);
       // Initialize children to the tree sentinel `_nil` (represents null leaves).
       new_node->_left   = nil;
       new_node->_right  = nil;
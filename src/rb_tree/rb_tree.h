@@ -3,11 +3,14 @@
 
 # include <bits/c++config.h>    // For std::size_t
 # include <bits/stl_pair.h>     // For std::pair
+# include <bits/move.h>         // For std::swap
 # include <bits/stl_function.h> // For std::less
 
 # include "rb_tree_node.h"     // For cxx::rb_tree_node
 # include "rb_tree_iterator.h" // For cxx::rb_tree_iterator, cxx::rb_tree_const_iterator
+# include "rb_tree_range.h"    // For cxx::rb_tree_cursor, cxx::rb_tree_range
 # include "rb_tree_utility.h"  // For cxx::_clear_rb_tree, cxx::_height_rb_tree
+# include "rb_tree_hot_cache.h" // For cxx::rb_tree_no_cache
 
 namespace cxx {
 
@@ -20,26 +23,32 @@ namespace cxx {
   ///
   /// @tparam ValueType Type of values stored in the tree.
   /// @tparam Compare Comparison functor used to order elements, defaults to std::less<ValueType>.
+  /// @tparam CachePolicy Hot-key cache consulted by `search`, defaults to rb_tree_no_cache<ValueType>
+  ///         (see rb_tree_direct_mapped_cache for a caching policy).
   ///
-  template <typename ValueType, typename Compare = std::less<ValueType>>
+  template <typename ValueType, typename Compare = std::less<ValueType>,
+            typename CachePolicy = rb_tree_no_cache<ValueType>>
   class rb_tree
   {
-    using node       = rb_tree_node<ValueType>;
-    using base       = typename node::base;
-    using node_ptr   = node*;
-    using base_ptr   = typename node::base_ptr;
-    using color      = typename base::color;
+    using node           = rb_tree_node<ValueType>;
+    using base           = typename node::base;
+    using node_ptr       = node*;
+    using const_node_ptr = const node*;
+    using base_ptr       = typename node::base_ptr;
+    using color          = typename base::color;
   
   public:
     using value_type = ValueType;
     using reference  = ValueType&;
     using pointer    = ValueType*;
     using cmp_type   = Compare;
+    using cache_type = CachePolicy;
     using size_type  = std::size_t;
     
   public:
-    using iterator        = rb_tree_iterator<node>;
-    using const_iterator  = rb_tree_const_iterator<node>;
+    using iterator        = rb_tree_iterator<ValueType>;
+    using const_iterator  = rb_tree_const_iterator<ValueType>;
+    using range_type      = rb_tree_range<ValueType, Compare>;
     
   public:
     using pair_type  = std::pair<iterator, bool>;
@@ -56,29 +65,49 @@ namespace cxx {
 
     /// @brief Copy constructor. Creates a deep copy of another Red-Black Tree.
     rb_tree(const rb_tree& other)
-      : _comp { other._comp }, _size { other._size }
+      : _size { other._size }, _comp { other._comp }
     {
-      _copy(other._root, other._nil);
+      _nil = new base;
+      _nil->_color  = color::Black;
+      _root = _nil;
+      try {
+        _copy(other._root, other._nil);
+      } catch ( ... ) {
+        delete _nil; // The destructor does not run for a constructor that throws
+        throw;
+      }
     }
 
     /// @brief Destructor. Clears the tree and releases resources.
     ~rb_tree() {
-      clear(_root, _nil);
+      clear();
       delete _nil;
     }
 
-    /// @brief Assignment operator.
+    /// @brief Assignment operator. If copying a value throws, the tree is left empty.
     rb_tree& operator=(const rb_tree& other);
 
     public:
 
     /// @brief Removes all elements from the tree.
     void clear() noexcept {
-      _clear_rb_tree(_root, _nil);
+      _cache.clear();
+      _clear_rb_tree<ValueType>(_root, _nil);
       _root = _nil;
       _size = 0;
     }
 
+    /// @brief Exchanges the contents of two trees without copying or allocating.
+    /// Both hot-key caches are cleared, the comparison functors are exchanged.
+    void swap(rb_tree& other) noexcept {
+      _cache.clear();
+      other._cache.clear();
+      std::swap(_root, other._root);
+      std::swap(_nil,  other._nil);
+      std::swap(_size, other._size);
+      std::swap(_comp, other._comp);
+    }
+
     /// @brief Returns the number of elements in the tree.
     [[nodiscard]]
     size_type size() const noexcept {
@@ -103,23 +132,29 @@ namespace cxx {
       return _height_rb_tree(_root, _nil);
     }
 
+    /// @brief Returns the hot-key cache, e.g. to read its hit/miss counters.
     [[nodiscard]]
-    const node_ptr root() const noexcept {
-      return _root;
+    const cache_type& cache() const noexcept {
+      return _cache;
     }
 
     [[nodiscard]]
-    const base_ptr nil() const noexcept {
+    const_node_ptr root() const noexcept {
+      return static_cast<node_ptr>(_root);
+    }
+
+    [[nodiscard]]
+    const base* nil() const noexcept {
       return _nil;
     }
 
     [[nodiscard]]
-    const node_ptr min() const noexcept {
+    const_node_ptr min() const noexcept {
       return static_cast<node_ptr>(base::_minimum(_root, _nil));
     }
 
     [[nodiscard]]
-    const node_ptr max() const noexcept {
+    const_node_ptr max() const noexcept {
       return static_cast<node_ptr>(base::_maximum(_root, _nil));
     }
 
@@ -127,20 +162,135 @@ namespace cxx {
     /// @param value The value to insert.
     /// @return A pair containing a pointer to the inserted node and a boolean indicating success.
     pair_type insert(const value_type& value) {
-      return _insert(new_node);
+      return _insert(value);
+    }
+
+    /// @brief Replaces the contents of the tree with the values of a sorted range.
+    ///
+    /// Builds a balanced tree directly in O(n), without comparisons or rotations:
+    /// every subtree is rooted at the middle of its range, and when the deepest
+    /// level is incomplete its nodes are colored red so all paths keep the same
+    /// black height.
+    ///
+    /// If copying a value throws, the tree keeps its previous contents.
+    ///
+    /// @param first, last Random-access range of values, strictly increasing under the comparator.
+    template <typename RandomIt>
+    void assign_sorted(RandomIt first, RandomIt last) {
+      const size_type count = static_cast<size_type>(last - first);
+
+      // Depth of the deepest level, and whether that level is full
+      size_type deepest = 0;
+      while ( (size_type { 2 } << deepest) - 1 < count ) {
+        ++deepest;
+      }
+      const bool full = (size_type { 2 } << deepest) - 1 == count;
+
+      base_ptr root = _nil;
+      try {
+        _build_sorted(first, 0, count, 0, full ? deepest + 1 : deepest, _nil, root);
+      } catch ( ... ) {
+        _clear_rb_tree<ValueType>(root, _nil);
+        throw;
+      }
+
+      clear();
+      _root = root;
+      _size = count;
     }
 
     /// @brief Searches for a node with the given value.
     /// @param value The value to search for.
     /// @return Pointer to the node if found, nullptr otherwise.
-    const node_ptr search(const value_type& value) const noexcept {
+    const_node_ptr search(const value_type& value) const noexcept {
+      const auto equivalent = [this, &value](const node_ptr n) { return _values_equivalent(n, value); };
+      if ( node_ptr cached = _cache.find(value, equivalent); cached != nullptr ) {
+        return cached; // Hot value, no descent needed
+      }
+
       node_ptr result = _search(value);
       if ( result != _nil && _values_equivalent(result, value) ) {
+        _cache.remember(value, result);
         return result; // Value found
       }
 
       return nullptr; // Value not found
     }
+
+    /// @brief Searches for the first value not less than the given value.
+    /// @param value The value to search for.
+    /// @return Pointer to the node if found, nullptr if every value is less than `value`.
+    const_node_ptr lower_bound(const value_type& value) const noexcept {
+      node_ptr result = nullptr;
+      base_ptr current = _root;
+      while ( current != _nil ) {
+        const node_ptr n = static_cast<node_ptr>(current);
+        if ( _comp(n->_value, value) ) {
+          current = n->_right;
+        } else {
+          result  = n; // Candidate, a smaller one may still be on the left
+          current = n->_left;
+        }
+      }
+
+      return result;
+    }
+
+    /// @brief Returns a single-pass view over the values within [lo, hi), in order.
+    /// @param lo Inclusive lower bound, copied into the view.
+    /// @param hi Exclusive upper bound, copied into the view.
+    [[nodiscard]]
+    range_type range(const value_type& lo, const value_type& hi) const {
+      return range_type { _root, _nil, lo, hi, _comp };
+    }
+
+    /// @brief Calls `callback` with every value of the tree, in order.
+    /// @param callback Callable taking a `const value_type&`.
+    template <typename Callback>
+    void scan(Callback callback) const {
+      rb_tree_cursor<ValueType, Compare> cursor { _root, _nil, _comp };
+      while ( const auto* n = cursor.next() ) {
+        callback(n->_value);
+      }
+    }
+
+    /// @brief Calls `callback` with every value within [lo, hi), in order.
+    /// @param lo Inclusive lower bound.
+    /// @param hi Exclusive upper bound.
+    /// @param callback Callable taking a `const value_type&`.
+    template <typename Callback>
+    void scan(const value_type& lo, const value_type& hi, Callback callback) const {
+      rb_tree_cursor<ValueType, Compare> cursor { _root, _nil, lo, hi, _comp };
+      while ( const auto* n = cursor.next() ) {
+        callback(n->_value);
+      }
+    }
+
+    /// @brief Hands the values within [lo, hi) to `callback` in order, BatchSize at a time.
+    /// @param lo Inclusive lower bound.
+    /// @param hi Exclusive upper bound.
+    /// @param callback Callable taking `(const value_type* const* values, size_type count)`,
+    ///        count is BatchSize for every batch except possibly the last one.
+    /// @tparam BatchSize Maximum number of values per batch.
+    template <size_type BatchSize = 64, typename Callback>
+    void scan_batched(const value_type& lo, const value_type& hi, Callback callback) const {
+      static_assert(BatchSize != 0, "BatchSize must not be 0");
+
+      const value_type* batch[BatchSize];
+      size_type         count = 0;
+      rb_tree_cursor<ValueType, Compare> cursor { _root, _nil, lo, hi, _comp };
+      while ( const auto* n = cursor.next() ) {
+        batch[count++] = &n->_value;
+        if ( count == BatchSize ) {
+          callback(static_cast<const value_type* const*>(batch), count);
+          count = 0;
+        }
+      }
+
+      if ( count != 0 ) {
+        callback(static_cast<const value_type* const*>(batch), count);
+      }
+    }
     
   private:
     /// @brief Searches for a node with the given value.
@@ -151,7 +301,44 @@ namespace cxx {
     /// @brief Copies the structure and elements from another tree.
     /// @param other_root Root of the other tree to copy from.
     /// @param other_nil Sentinel node of the other tree.
-    void _copy(const node_ptr other_root, const base_ptr other_nil);
+    void _copy(const base_ptr other_root, const base_ptr other_nil);
+
+    /// @brief Clones a subtree node by node, keeping its shape and colors.
+    ///
+    /// Each node is linked before its children are cloned, so if an allocation
+    /// throws, everything cloned so far is reachable from `link`.
+    ///
+    /// @param other Root of the subtree to clone.
+    /// @param other_nil Sentinel node of the other tree.
+    /// @param parent Parent of the cloned subtree in this tree.
+    /// @param link Receives the root of the cloned subtree, must be _nil on entry.
+    void _clone(const base_ptr other, const base_ptr other_nil, const base_ptr parent, base_ptr& link);
+
+    /// @brief Builds a balanced subtree from the sorted values first[lo, hi).
+    ///
+    /// Each node is linked before its children are built, so if an allocation
+    /// throws, everything built so far is reachable from `link`.
+    ///
+    /// @param depth Depth of the subtree root.
+    /// @param red_depth Depth whose nodes are colored red, past the deepest level if none.
+    /// @param parent Parent of the built subtree.
+    /// @param link Receives the root of the built subtree, must be _nil on entry.
+    template <typename RandomIt>
+    void _build_sorted(RandomIt first, size_type lo, size_type hi,
+                       size_type depth, size_type red_depth, const base_ptr parent, base_ptr& link)
+    {
+      if ( lo == hi ) {
+        return;
+      }
+
+      const size_type mid = lo + (hi - lo) / 2;
+      node_ptr n  = node::create_node(first[mid], _nil);
+      n->_color   = depth == red_depth ? color::Red : color::Black;
+      n->_parent  = parent;
+      link        = n;
+      _build_sorted(first, lo, mid, depth + 1, red_depth, n, n->_left);
+      _build_sorted(first, mid + 1, hi, depth + 1, red_depth, n, n->_right);
+    }
 
     /// @brief Check if a node's value is equal to a given value using the tree comparator.
     /// @param n Pointer to the node to compare.
@@ -167,15 +354,16 @@ namespace cxx {
     /// @return A pair containing a pointer to the inserted node and a boolean indicating success.
     pair_type _insert(const value_type& value);
   private:
-    node_ptr  _root { nullptr }; ///< Pointer to the root node of the tree.
-    base_ptr  _nil  { nullptr }; ///< Sentinel node representing leaf/null in the Red-Black Tree.
-    size_type _size { 0 };       ///< Number of nodes in the tree.
-    cmp_type  _comp;             ///< Comparison functor for ordering elements.
+    base_ptr           _root { nullptr }; ///< Pointer to the root node of the tree, _nil when empty.
+    base_ptr           _nil  { nullptr }; ///< Sentinel node representing leaf/null in the Red-Black Tree.
+    size_type          _size { 0 };       ///< Number of nodes in the tree.
+    cmp_type           _comp;             ///< Comparison functor for ordering elements.
+    mutable cache_type _cache;            ///< Hot-key cache consulted by `search`, kept coherent by `clear`.
   };
 
-  template <typename ValueType, typename Compare>
-  rb_tree<ValueType, Compare>&
-  rb_tree<ValueType, Compare>::operator=(const rb_tree& other)
+  template <typename ValueType, typename Compare, typename CachePolicy>
+  rb_tree<ValueType, Compare, CachePolicy>&
+  rb_tree<ValueType, Compare, CachePolicy>::operator=(const rb_tree& other)
   {
     if ( this == &other ) {
       return *this;
@@ -188,45 +376,62 @@ namespace cxx {
     return *this;
   }
 
-  template <typename ValueType, typename Compare>
-  void rb_tree<ValueType, Compare>::
-  _copy(const node_ptr other_root, const base_ptr other_nil)
+  template <typename ValueType, typename Compare, typename CachePolicy>
+  void rb_tree<ValueType, Compare, CachePolicy>::
+  _copy(const base_ptr other_root, const base_ptr other_nil)
+  {
+    // The source is already balanced, so copy its shape instead of re-inserting every value
+    base_ptr root = _nil;
+    try {
+      _clone(other_root, other_nil, _nil, root);
+    } catch ( ... ) {
+      _clear_rb_tree<ValueType>(root, _nil);
+      throw;
+    }
+
+    _root = root;
+  }
+
+  template <typename ValueType, typename Compare, typename CachePolicy>
+  void rb_tree<ValueType, Compare, CachePolicy>::
+  _clone(const base_ptr other, const base_ptr other_nil, const base_ptr parent, base_ptr& link)
   {
-    if ( other_root == other_nil ) {
+    if ( other == other_nil ) {
       return;
     }
 
-    // Insert the new node into the tree
-    insert(other_root->_value);
-    // Recursively copy the left and right subtrees
-    _copy(other_root->_left, other_nil);
-    _copy(other_root->_right, other_nil);
+    node_ptr copy = node::create_node(static_cast<node_ptr>(other)->_value, _nil);
+    copy->_color  = other->_color;
+    copy->_parent = parent;
+    link          = copy;
+    _clone(other->_left, other_nil, copy, copy->_left);
+    _clone(other->_right, other_nil, copy, copy->_right);
   }
 
-  template <typename ValueType, typename Compare>
-  typename rb_tree<ValueType, Compare>::node_ptr
-  rb_tree<ValueType, Compare>::_search(const value_type& value) const noexcept
+  template <typename ValueType, typename Compare, typename CachePolicy>
+  typename rb_tree<ValueType, Compare, CachePolicy>::node_ptr
+  rb_tree<ValueType, Compare, CachePolicy>::_search(const value_type& value) const noexcept
   {
-    node_ptr current = _root;
-    node_ptr parent  = _nil;
+    base_ptr current = _root;
+    base_ptr parent  = _nil;
 
     while ( current != _nil ) {
       parent = current;
-      if ( _comp(value, current->_value) ) {
+      if ( _comp(value, static_cast<node_ptr>(current)->_value) ) {
         current = current->_left;
-      } else if ( _comp(current->_value, value) ) {
+      } else if ( _comp(static_cast<node_ptr>(current)->_value, value) ) {
         current = current->_right;
       } else {
-        return current; // Value found
+        return static_cast<node_ptr>(current); // Value found
       }
     }
 
-    return parent; // Value not found
+    return static_cast<node_ptr>(parent); // Value not found
   }
 
-  template <typename ValueType, typename Compare>
-  typename rb_tree<ValueType, Compare>::pair_type
-  rb_tree<ValueType, Compare>::_insert(const value_type& value)
+  template <typename ValueType, typename Compare, typename CachePolicy>
+  typename rb_tree<ValueType, Compare, CachePolicy>::pair_type
+  rb_tree<ValueType, Compare, CachePolicy>::_insert(const value_type& value)
   {
     node_ptr parent = _search(value);
     if ( parent != _nil && _values_equivalent(parent, value) ) {
@@ -244,8 +449,7 @@ namespace cxx {
     }
 
     ++_size;
-    // Todo: Implement _insert_fixup to maintain Red-Black properties after insertion
-    _insert_fixup(new_node, _root, _nil);
+    base::_insert_fixup(new_node, _root, _nil);
     return { iterator { new_node, _nil }, true };
   }
 } // namespace cxx
@@ -0,0 +1,303 @@
+#ifndef   __SHARDED_RB_TREE__
+# define  __SHARDED_RB_TREE__
+
+# include <algorithm>  // For std::upper_bound
+# include <atomic>     // For std::atomic, std::memory_order_acquire, std::memory_order_release
+# include <memory>     // For std::unique_ptr, std::make_unique
+# include <mutex>      // For std::mutex, std::lock_guard, std::unique_lock
+# include <optional>   // For std::optional
+# include <utility>    // For std::move
+# include <vector>     // For std::vector
+
+# include "rb_tree.h"  // For cxx::rb_tree, cxx::rb_tree_cache_line_size
+
+namespace cxx {
+
+  ///
+  /// @brief Ordered set split across independently locked Red-Black Trees.
+  ///
+  /// The key space is range-partitioned by N - 1 sorted boundaries into N shards:
+  /// shard i holds the values in [boundaries[i - 1], boundaries[i]). Each shard is
+  /// a rb_tree guarded by its own mutex, so writers touching different shards do
+  /// not contend. Because shards are disjoint and ordered, global in-order
+  /// traversal visits the shards one after another, and `lower_bound` only has to
+  /// look at the owning shard and the ones after it.
+  ///
+  /// The boundaries are an immutable array published through an atomic pointer.
+  /// An operation loads it without any read-modify-write, picks and locks a shard,
+  /// then checks the pointer again and retries if `rebalance` swapped it in the
+  /// meantime. `rebalance` publishes the new array while holding every shard lock.
+  /// Replaced arrays are kept until the container is destroyed, so a pointer loaded
+  /// by a concurrent operation never dangles.
+  ///
+  /// Traversals copy the values of one shard out under its lock and call the
+  /// callback without holding any lock, so the callback may use the container.
+  /// They are not a snapshot of the whole container under concurrent writes.
+  ///
+  /// @tparam ValueType Type of values stored in the tree, must be copyable.
+  /// @tparam Compare Comparison functor used to order elements, defaults to std::less<ValueType>.
+  ///
+  template <typename ValueType, typename Compare = std::less<ValueType>>
+  class sharded_rb_tree
+  {
+  public:
+    using value_type = ValueType;
+    using cmp_type   = Compare;
+    using size_type  = std::size_t;
+    using tree_type  = rb_tree<ValueType, Compare>;
+
+  private:
+    using boundaries_type = std::vector<value_type>;
+
+  public:
+    /// @brief Constructs an empty container with boundaries.size() + 1 shards.
+    /// @param boundaries Strictly increasing values separating consecutive shards.
+    /// @param comp Comparison functor.
+    explicit sharded_rb_tree(boundaries_type boundaries, const cmp_type& comp = cmp_type())
+      : _shards ( boundaries.size() + 1 ), _comp { comp }
+    {
+      _generations.push_back(std::make_unique<const boundaries_type>(std::move(boundaries)));
+      _boundaries.store(_generations.back().get(), std::memory_order_release);
+    }
+
+    sharded_rb_tree(const sharded_rb_tree&) = delete;
+    sharded_rb_tree& operator=(const sharded_rb_tree&) = delete;
+
+  public:
+    /// @brief Inserts a value into its shard.
+    /// @param value The value to insert.
+    /// @return true if the value was inserted, false if it was already present.
+    bool insert(const value_type& value) {
+      size_type              index;
+      const boundaries_type* bounds;
+      const auto guard = _lock_owner(&value, index, bounds);
+      return _shards[index]._tree.insert(value).second;
+    }
+
+    /// @brief Checks whether an equivalent value is stored.
+    [[nodiscard]]
+    bool contains(const value_type& value) const {
+      size_type              index;
+      const boundaries_type* bounds;
+      const auto guard = _lock_owner(&value, index, bounds);
+      return _shards[index]._tree.search(value) != nullptr;
+    }
+
+    /// @brief Finds the first value not less than the given value across all shards.
+    /// @param value The value to search for.
+    /// @return A copy of the found value, std::nullopt if every value is less than `value`.
+    [[nodiscard]]
+    std::optional<value_type> lower_bound(const value_type& value) const {
+      const value_type* from = &value;
+      for ( ;; ) {
+        size_type              index;
+        const boundaries_type* bounds;
+        const auto guard = _lock_owner(from, index, bounds);
+        if ( const auto* n = _shards[index]._tree.lower_bound(*from) ) {
+          return n->_value;
+        }
+
+        if ( index + 1 == _shards.size() ) {
+          return std::nullopt;
+        }
+
+        from = &(*bounds)[index]; // Continue with the smallest value of the next shard
+      }
+    }
+
+    /// @brief Calls `callback` with every value, in global order.
+    /// @param callback Callable taking a `const value_type&`.
+    template <typename Callback>
+    void scan(Callback callback) const {
+      _scan(nullptr, nullptr, callback);
+    }
+
+    /// @brief Calls `callback` with every value within [lo, hi), in global order.
+    /// @param lo Inclusive lower bound.
+    /// @param hi Exclusive upper bound.
+    /// @param callback Callable taking a `const value_type&`.
+    template <typename Callback>
+    void scan(const value_type& lo, const value_type& hi, Callback callback) const {
+      _scan(&lo, &hi, callback);
+    }
+
+    /// @brief Moves shard boundaries so every shard holds about the same number of values.
+    ///
+    /// Holds every shard lock while it runs. Boundaries are left unchanged
+    /// when there are fewer values than shards. The new shards are built
+    /// next to the old ones, so it briefly needs twice the memory, and if
+    /// anything throws the container is left as it was.
+    void rebalance() {
+      std::lock_guard<std::mutex> serial { _rebalance_mutex };
+
+      // Declared before the locks, so the replaced trees are released after unlocking
+      std::vector<tree_type> rebuilt;
+      rebuilt.reserve(_shards.size());
+
+      // Other operations hold at most one shard lock at a time, so taking all of them in order is safe
+      std::vector<std::unique_lock<std::mutex>> guards;
+      guards.reserve(_shards.size());
+      for ( shard& s : _shards ) {
+        guards.emplace_back(s._mutex);
+      }
+
+      std::vector<value_type> values;
+      for ( const shard& s : _shards ) {
+        s._tree.scan([&values](const value_type& v) { values.push_back(v); });
+      }
+
+      const size_type count = _shards.size();
+      if ( values.size() < count ) {
+        return;
+      }
+
+      boundaries_type next;
+      next.reserve(count - 1);
+      for ( size_type i = 1; i < count; ++i ) {
+        next.push_back(values[i * values.size() / count]);
+      }
+
+      // Values are sorted and unique, each new shard is built from its slice in O(n)
+      for ( size_type i = 0; i < count; ++i ) {
+        const auto first = values.begin() + static_cast<std::ptrdiff_t>(i * values.size() / count);
+        const auto last  = values.begin() + static_cast<std::ptrdiff_t>((i + 1) * values.size() / count);
+        rebuilt.emplace_back(_comp);
+        rebuilt.back().assign_sorted(first, last);
+      }
+
+      // Appended but not yet published, the current boundaries still route every operation
+      _generations.push_back(std::make_unique<const boundaries_type>(std::move(next)));
+
+      // Nothing below throws: install every new shard, then publish the boundaries they were built for
+      for ( size_type i = 0; i < count; ++i ) {
+        _shards[i]._tree.swap(rebuilt[i]);
+      }
+      _boundaries.store(_generations.back().get(), std::memory_order_release);
+    }
+
+    /// @brief Removes all elements from every shard.
+    void clear() {
+      for ( shard& s : _shards ) {
+        std::lock_guard<std::mutex> guard { s._mutex };
+        s._tree.clear();
+      }
+    }
+
+    /// @brief Returns the number of elements across all shards.
+    [[nodiscard]]
+    size_type size() const {
+      size_type total = 0;
+      for ( const shard& s : _shards ) {
+        std::lock_guard<std::mutex> guard { s._mutex };
+        total += s._tree.size();
+      }
+
+      return total;
+    }
+
+    /// @brief Checks if every shard is empty.
+    [[nodiscard]]
+    bool empty() const {
+      return size() == 0;
+    }
+
+    /// @brief Returns the number of shards.
+    [[nodiscard]]
+    size_type shard_count() const noexcept {
+      return _shards.size();
+    }
+
+    /// @brief Returns a copy of the current shard boundaries.
+    [[nodiscard]]
+    boundaries_type boundaries() const {
+      return *_boundaries.load(std::memory_order_acquire);
+    }
+
+  private:
+    /// @brief One partition of the key space, padded to its own cache lines
+    ///        so that locking neighbouring shards does not cause false sharing.
+    struct alignas(rb_tree_cache_line_size) shard
+    {
+      mutable std::mutex _mutex; ///< Guards `_tree`.
+      tree_type          _tree;  ///< Values of this partition.
+    };
+
+  private:
+    /// @brief Returns the index of the shard owning `value` under the given boundaries.
+    size_type _shard_of(const boundaries_type& bounds, const value_type& value) const {
+      const auto it = std::upper_bound(bounds.begin(), bounds.end(), value, _comp);
+      return static_cast<size_type>(it - bounds.begin());
+    }
+
+    /// @brief Locks the shard owning `value`, retrying if the boundaries change meanwhile.
+    /// @param value The value to route, nullptr for the first shard.
+    /// @param index Receives the index of the locked shard.
+    /// @param bounds Receives the boundaries the shard was chosen with, stable while locked.
+    /// @return Lock held on the shard.
+    std::unique_lock<std::mutex>
+    _lock_owner(const value_type* value, size_type& index, const boundaries_type*& bounds) const {
+      for ( ;; ) {
+        bounds = _boundaries.load(std::memory_order_acquire);
+        index  = value != nullptr ? _shard_of(*bounds, *value) : 0;
+        std::unique_lock<std::mutex> guard { _shards[index]._mutex };
+        // rebalance publishes under every shard lock, so an unchanged pointer means a valid choice
+        if ( _boundaries.load(std::memory_order_acquire) == bounds ) {
+          return guard;
+        }
+      }
+    }
+
+    /// @brief Calls `callback` with the values within [lo, hi) shard by shard, without holding locks.
+    /// @param lo Inclusive lower bound, nullptr if unbounded.
+    /// @param hi Exclusive upper bound, nullptr if unbounded.
+    template <typename Callback>
+    void _scan(const value_type* lo, const value_type* hi, Callback& callback) const {
+      std::vector<value_type> batch;
+      const value_type* from = lo;
+      for ( ;; ) {
+        size_type              index;
+        const boundaries_type* bounds;
+        {
+          const auto guard = _lock_owner(from, index, bounds);
+          // Values of this shard are below its upper boundary, clamp it to `hi`
+          const value_type* upper = index + 1 < _shards.size() ? &(*bounds)[index] : nullptr;
+          if ( hi != nullptr && (upper == nullptr || _comp(*hi, *upper)) ) {
+            upper = hi;
+          }
+
+          const tree_type& tree = _shards[index]._tree;
+          if ( from != nullptr && upper != nullptr ) {
+            tree.scan(*from, *upper, [&batch](const value_type& v) { batch.push_back(v); });
+          } else {
+            tree.scan([&](const value_type& v) {
+              if ( (from == nullptr || !_comp(v, *from)) && (upper == nullptr || _comp(v, *upper)) ) {
+                batch.push_back(v);
+              }
+            });
+          }
+        }
+
+        for ( const value_type& v : batch ) {
+          callback(v);
+        }
+        batch.clear();
+
+        if ( index + 1 == _shards.size() || (hi != nullptr && !_comp((*bounds)[index], *hi)) ) {
+          return;
+        }
+
+        from = &(*bounds)[index]; // Continue with the next shard, whatever the boundaries are by then
+      }
+    }
+
+  private:
+    std::vector<shard>                                  _shards;                 ///< Independently locked partitions.
+    std::atomic<const boundaries_type*>                 _boundaries { nullptr }; ///< Current sorted values separating consecutive shards.
+    std::vector<std::unique_ptr<const boundaries_type>> _generations;            ///< Every boundaries array published so far.
+    std::mutex                                          _rebalance_mutex;        ///< Serializes `rebalance` and guards `_generations`.
+    cmp_type                                            _comp;                   ///< Comparison functor for ordering elements.
+  };
+
+} // namespace cxx
+
+#endif // __SHARDED_RB_TREE__
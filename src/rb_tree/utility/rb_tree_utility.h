@@ -12,15 +12,15 @@ namespace cxx {
   /// @param nil Sentinel node pointer (not deleted).
   /// @tparam ValueType The type of value stored in the node.
   template <typename ValueType>
-  inline void _clear_rb_tree(rb_tree_node<ValueType>* node, const rb_tree_base_node* nil) noexcept
+  inline void _clear_rb_tree(rb_tree_base_node* node, const rb_tree_base_node* nil) noexcept
   {
     if ( node == nil ) {
       return;
     }
 
-    _clear_rb_tree(node->_left, nil);
-    _clear_rb_tree(node->_right, nil);
-    delete node;
+    _clear_rb_tree<ValueType>(node->_left, nil);
+    _clear_rb_tree<ValueType>(node->_right, nil);
+    delete static_cast<rb_tree_node<ValueType>*>(node);
   }
 
   /// @brief Calculate the height of the subtree rooted at `node`.
@@ -0,0 +1,183 @@
+#include <cassert>  // For assert
+#include <cstddef>  // For std::size_t
+#include <cstdio>   // For std::puts
+#include <thread>   // For std::thread
+#include <vector>   // For std::vector
+
+#include "rb_tree.h"            // For cxx::rb_tree
+#include "rb_tree_hot_cache.h"  // For cxx::rb_tree_direct_mapped_cache, cxx::rb_tree_no_cache
+
+namespace {
+
+  template <std::size_t Slots = 16384, typename Hash = std::hash<int>>
+  using counting_cache = cxx::rb_tree_direct_mapped_cache<int, Slots, Hash, true>;
+
+  using cached_tree = cxx::rb_tree<int, std::less<int>, counting_cache<>>;
+
+  /// @brief Sends every value to the same slot, to exercise eviction.
+  struct constant_hash
+  {
+    std::size_t operator()(int) const noexcept {
+      return 7;
+    }
+  };
+
+  void test_hits_and_misses() {
+    cached_tree t;
+    for ( int i = 0; i < 100; ++i ) {
+      t.insert(i);
+    }
+
+    const auto* first = t.search(5);
+    assert(first != nullptr && first->_value == 5);
+    assert(t.cache().hits() == 0 && t.cache().misses() == 1);
+
+    assert(t.search(5) == first);
+    assert(t.cache().hits() == 1 && t.cache().misses() == 1);
+
+    // Absent values are not remembered
+    assert(t.search(1000) == nullptr);
+    assert(t.search(1000) == nullptr);
+    assert(t.cache().hits() == 1 && t.cache().misses() == 3);
+  }
+
+  void test_clear_keeps_cache_coherent() {
+    cached_tree t;
+    t.insert(5);
+    assert(t.search(5) != nullptr);
+    assert(t.search(5) != nullptr);
+    assert(t.cache().hits() == 1);
+
+    // The cached node is freed by clear(), a stale slot would be a use-after-free
+    t.clear();
+    assert(t.search(5) == nullptr);
+    assert(t.cache().hits() == 1 && t.cache().misses() == 2);
+
+    t.insert(5);
+    const auto* fresh = t.search(5);
+    assert(fresh != nullptr && fresh->_value == 5);
+    assert(t.search(5) == fresh);
+    assert(t.cache().hits() == 2);
+  }
+
+  void test_collisions_evict_and_verify() {
+    cxx::rb_tree<int, std::less<int>, counting_cache<1, constant_hash>> t;
+    t.insert(1);
+    t.insert(2);
+
+    assert(t.search(1)->_value == 1); // miss, cached
+    assert(t.search(2)->_value == 2); // same hash, equivalence check rejects 1: miss, evicts 1
+    assert(t.search(1)->_value == 1); // miss again
+    assert(t.search(1)->_value == 1); // hit
+    assert(t.cache().hits() == 1 && t.cache().misses() == 3);
+  }
+
+  void test_hot_key_survives_one_cold_miss() {
+    cxx::rb_tree<int, std::less<int>, counting_cache<1, constant_hash>> t;
+    t.insert(1);
+    t.insert(2);
+
+    assert(t.search(1) != nullptr); // miss, cached
+    assert(t.search(1) != nullptr); // hit, referenced
+    assert(t.search(2) != nullptr); // miss, 1 keeps the slot but loses its reference
+    assert(t.search(1) != nullptr); // hit, referenced again
+    assert(t.cache().hits() == 2 && t.cache().misses() == 2);
+
+    // Without a hit in between, the second miss replaces the owner
+    assert(t.search(2) != nullptr);
+    assert(t.search(2) != nullptr);
+    assert(t.search(2) != nullptr);
+    assert(t.cache().hits() == 3 && t.cache().misses() == 4);
+  }
+
+  void test_power_of_two_stride_spreads() {
+    // std::hash<int> is the identity, a plain low-bits index would put all of these in one slot
+    cxx::rb_tree<int, std::less<int>, counting_cache<64>> t;
+    for ( int i = 0; i < 16; ++i ) {
+      t.insert(i << 12);
+    }
+    for ( int round = 0; round < 2; ++round ) {
+      for ( int i = 0; i < 16; ++i ) {
+        assert(t.search(i << 12) != nullptr);
+      }
+    }
+    // Distinct slots turn the second round into hits, a few pairs may still collide
+    assert(t.cache().hits() >= 12 && t.cache().hits() + t.cache().misses() == 32);
+  }
+
+  void test_direct_cache_api() {
+    cxx::rb_tree_node<int> a { 3 };
+    cxx::rb_tree_node<int> b { 4 };
+    counting_cache<8> cache;
+    const auto holds = [](int v) { return [v](const cxx::rb_tree_node<int>* n) { return n->_value == v; }; };
+
+    assert(cache.find(3, holds(3)) == nullptr);
+    cache.remember(3, &a);
+    cache.remember(4, &b);
+    assert(cache.find(3, holds(3)) == &a);
+    assert(cache.find(4, holds(4)) == &b);
+
+    cache.forget(3);
+    assert(cache.find(3, holds(3)) == nullptr);
+    assert(cache.find(4, holds(4)) == &b);
+
+    cache.clear();
+    assert(cache.find(4, holds(4)) == nullptr);
+    assert(cache.hits() == 3 && cache.misses() == 3);
+  }
+
+  void test_counting_is_opt_in() {
+    cxx::rb_tree<int> plain;
+    plain.insert(1);
+    assert(plain.search(1) != nullptr && plain.search(1) != nullptr);
+    assert(plain.cache().hits() == 0 && plain.cache().misses() == 0);
+
+    // Still caches, only the counters stay untouched
+    cxx::rb_tree<int, std::less<int>, cxx::rb_tree_direct_mapped_cache<int>> t;
+    t.insert(1);
+    const auto* first = t.search(1);
+    assert(first != nullptr && t.search(1) == first && t.search(2) == nullptr);
+    assert(t.cache().hits() == 0 && t.cache().misses() == 0);
+  }
+
+  void test_concurrent_readers() {
+    cached_tree t;
+    for ( int i = 0; i < 1000; ++i ) {
+      t.insert(i);
+    }
+
+    constexpr int threads = 4;
+    constexpr int lookups = 10000;
+    const cached_tree& reader = t;
+    std::vector<std::thread> pool;
+    for ( int id = 0; id < threads; ++id ) {
+      pool.emplace_back([&reader] {
+        for ( int i = 0; i < lookups; ++i ) {
+          const int v = i % 64;
+          const auto* n = reader.search(v);
+          assert(n != nullptr && n->_value == v);
+        }
+      });
+    }
+    for ( std::thread& th : pool ) {
+      th.join();
+    }
+
+    assert(t.cache().hits() + t.cache().misses() == threads * lookups);
+    assert(t.cache().hits() >= threads * lookups - threads * 64);
+  }
+
+} // namespace
+
+int main() {
+  test_hits_and_misses();
+  test_clear_keeps_cache_coherent();
+  test_collisions_evict_and_verify();
+  test_hot_key_survives_one_cold_miss();
+  test_power_of_two_stride_spreads();
+  test_direct_cache_api();
+  test_counting_is_opt_in();
+  test_concurrent_readers();
+  std::puts("rb_tree_hot_cache_test: OK");
+  return 0;
+}
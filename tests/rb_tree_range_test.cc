@@ -0,0 +1,119 @@
+#include <cassert>      // For assert
+#include <cstddef>      // For std::size_t
+#include <cstdio>       // For std::puts
+#include <iterator>     // For std::iterator_traits
+#include <string>       // For std::string
+#include <type_traits>  // For std::is_same_v
+#include <vector>       // For std::vector
+
+#include "rb_tree.h"  // For cxx::rb_tree
+
+namespace {
+
+  using tree = cxx::rb_tree<int>;
+
+  tree make_tree(int count) {
+    // Even values 0, 2, ..., 2 * (count - 1), inserted out of order
+    tree t;
+    for ( int i = 0; i < count; ++i ) {
+      t.insert(((i * 7919) % count) * 2);
+    }
+    return t;
+  }
+
+  void test_scan_bounds() {
+    const tree t = make_tree(1000);
+
+    std::vector<int> seen;
+    t.scan(11, 40, [&seen](int v) { seen.push_back(v); });
+    assert(seen.size() == 14 && seen.front() == 12 && seen.back() == 38);
+    for ( std::size_t i = 1; i < seen.size(); ++i ) {
+      assert(seen[i - 1] + 2 == seen[i]);
+    }
+
+    seen.clear();
+    t.scan(10, 10, [&seen](int v) { seen.push_back(v); });
+    t.scan(5000, 6000, [&seen](int v) { seen.push_back(v); });
+    t.scan(40, 10, [&seen](int v) { seen.push_back(v); });
+    assert(seen.empty());
+
+    std::size_t count = 0;
+    int         prev  = -1;
+    t.scan([&](int v) { assert(v > prev); prev = v; ++count; });
+    assert(count == 1000 && prev == 1998);
+  }
+
+  void test_scan_batched() {
+    const tree t = make_tree(1000);
+
+    std::vector<std::size_t> sizes;
+    int expected = 0;
+    t.scan_batched<64>(0, 2000, [&](const int* const* values, std::size_t count) {
+      sizes.push_back(count);
+      for ( std::size_t i = 0; i < count; ++i ) {
+        assert(*values[i] == expected);
+        expected += 2;
+      }
+    });
+    assert(expected == 2000);
+    assert(sizes.size() == 16 && sizes.front() == 64 && sizes.back() == 1000 - 15 * 64);
+
+    std::size_t calls = 0;
+    t.scan_batched<8>(3000, 4000, [&calls](const int* const*, std::size_t) { ++calls; });
+    assert(calls == 0);
+  }
+
+  void test_range_with_temporary_bounds() {
+    const tree t = make_tree(100);
+
+    // Bounds are temporaries that die before begin() runs
+    std::vector<int> seen;
+    for ( int v : t.range(10, 20) ) {
+      seen.push_back(v);
+    }
+    assert((seen == std::vector<int> { 10, 12, 14, 16, 18 }));
+
+    const std::string lo = "b";
+    cxx::rb_tree<std::string> words;
+    words.insert("a");
+    words.insert("bb");
+    words.insert("c");
+    std::vector<std::string> found;
+    for ( const std::string& w : words.range(lo, std::string { "c" }) ) {
+      found.push_back(w);
+    }
+    assert(found.size() == 1 && found.front() == "bb");
+  }
+
+  void test_range_iterator() {
+    using iterator = tree::range_type::iterator;
+    static_assert(sizeof(iterator) == 2 * sizeof(void*));
+    static_assert(std::is_same_v<std::iterator_traits<iterator>::iterator_category, std::input_iterator_tag>);
+
+    const tree t = make_tree(10);
+    auto range = t.range(4, 100);
+    iterator it = range.begin();
+    assert(*it == 4);
+    assert(*it++ == 4 && *it == 6);
+    assert(iterator {} == range.end());
+
+    // begin() restarts the walk, a copy walks independently
+    auto copy = range;
+    assert(*range.begin() == 4 && *copy.begin() == 4);
+    int count = 0;
+    for ( auto i = copy.begin(); i != copy.end(); ++i ) {
+      ++count;
+    }
+    assert(count == 8);
+  }
+
+} // namespace
+
+int main() {
+  test_scan_bounds();
+  test_scan_batched();
+  test_range_with_temporary_bounds();
+  test_range_iterator();
+  std::puts("rb_tree_range_test: OK");
+  return 0;
+}
@@ -0,0 +1,210 @@
+#include <cassert>    // For assert
+#include <cmath>      // For NAN
+#include <cstddef>    // For std::size_t
+#include <cstdio>     // For std::puts
+#include <stdexcept>  // For std::runtime_error
+#include <vector>     // For std::vector
+
+#include "rb_tree.h"  // For cxx::rb_tree
+
+namespace {
+
+  using tree = cxx::rb_tree<int>;
+  using base = cxx::rb_tree_base_node;
+  using node = cxx::rb_tree_node<int>;
+
+  // Small keys share the base node's tail padding: links and key fit in 32 bytes
+  static_assert(sizeof(node) == sizeof(base));
+
+  // Checks order, parent links and the Red-Black properties of the subtree rooted at `n`.
+  // Returns its black height.
+  std::size_t check_subtree(const base* n, const base* nil, const base* parent) {
+    if ( n == nil ) {
+      return 1;
+    }
+
+    assert(n->_parent == parent);
+    if ( n->_color == cxx::rb_tree_node_color::Red ) {
+      assert(n->_left->_color == cxx::rb_tree_node_color::Black);
+      assert(n->_right->_color == cxx::rb_tree_node_color::Black);
+    }
+    if ( n->_left != nil ) {
+      assert(static_cast<const node*>(n->_left)->_value < static_cast<const node*>(n)->_value);
+    }
+    if ( n->_right != nil ) {
+      assert(static_cast<const node*>(n)->_value < static_cast<const node*>(n->_right)->_value);
+    }
+
+    const std::size_t left  = check_subtree(n->_left, nil, n);
+    const std::size_t right = check_subtree(n->_right, nil, n);
+    assert(left == right);
+    return left + (n->_color == cxx::rb_tree_node_color::Black ? 1 : 0);
+  }
+
+  void check_tree(const tree& t) {
+    assert(t.empty() || t.root()->_color == cxx::rb_tree_node_color::Black);
+    check_subtree(t.empty() ? t.nil() : t.root(), t.nil(), t.nil());
+  }
+
+  void test_insert_keeps_balance() {
+    tree t;
+    for ( int i = 0; i < 1000; ++i ) {
+      assert(t.insert(i).second);
+    }
+    assert(!t.insert(500).second);
+    assert(t.size() == 1000);
+    assert(t.height() <= 20);
+    assert(t.min()->_value == 0 && t.max()->_value == 999);
+    check_tree(t);
+  }
+
+  void test_search() {
+    tree t;
+    for ( int i = 0; i < 100; i += 2 ) {
+      t.insert(i);
+    }
+    assert(t.search(42) != nullptr && t.search(42)->_value == 42);
+    assert(t.search(43) == nullptr);
+    assert(t.lower_bound(43)->_value == 44);
+    assert(t.lower_bound(99) == nullptr);
+  }
+
+  void test_copy_clones_shape() {
+    tree t;
+    for ( int i = 0; i < 257; ++i ) {
+      t.insert((i * 37) % 257);
+    }
+
+    const tree copy { t };
+    assert(copy.size() == t.size());
+    assert(copy.height() == t.height());
+    assert(copy.root() != t.root());
+    check_tree(copy);
+
+    tree assigned;
+    assigned.insert(-1);
+    assigned = copy;
+    assert(assigned.size() == 257);
+    assert(assigned.search(-1) == nullptr && assigned.search(256) != nullptr);
+    check_tree(assigned);
+
+    assigned.clear();
+    assert(assigned.empty() && assigned.height() == 0);
+    assert(assigned.insert(7).second);
+  }
+
+  void test_assign_sorted() {
+    for ( int count = 0; count < 300; ++count ) {
+      std::vector<int> values;
+      for ( int i = 0; i < count; ++i ) {
+        values.push_back(i * 3);
+      }
+
+      tree t;
+      t.insert(-5);
+      t.assign_sorted(values.begin(), values.end());
+      assert(t.size() == static_cast<std::size_t>(count));
+      assert(t.search(-5) == nullptr);
+      check_tree(t);
+      if ( count != 0 ) {
+        assert(t.min()->_value == 0 && t.max()->_value == (count - 1) * 3);
+        assert(t.search((count / 2) * 3) != nullptr);
+        assert(t.insert(count * 3).second);
+        check_tree(t);
+      }
+    }
+  }
+
+  /// @brief Value whose copy constructor throws once `copies_left` reaches 0, negative means never.
+  struct fragile
+  {
+    static inline int copies_left = -1;
+
+    int _v;
+
+    explicit fragile(int v) : _v { v } { }
+
+    fragile(const fragile& other) : _v { other._v } {
+      if ( copies_left == 0 ) {
+        throw std::runtime_error("copy failed");
+      }
+      if ( copies_left > 0 ) {
+        --copies_left;
+      }
+    }
+
+    bool operator<(const fragile& other) const noexcept {
+      return _v < other._v;
+    }
+  };
+
+  // Nodes built before the failing copy must be released, LeakSanitizer reports them otherwise
+  void test_throwing_copy_does_not_leak() {
+    std::vector<fragile> values;
+    for ( int i = 0; i < 100; ++i ) {
+      values.emplace_back(i);
+    }
+
+    cxx::rb_tree<fragile> t;
+    t.insert(fragile { -1 });
+    fragile::copies_left = 50;
+    bool thrown = false;
+    try {
+      t.assign_sorted(values.begin(), values.end());
+    } catch ( const std::runtime_error& ) {
+      thrown = true;
+    }
+    assert(thrown);
+    // The previous contents are kept
+    assert(t.size() == 1 && t.search(fragile { -1 }) != nullptr);
+
+    fragile::copies_left = -1;
+    t.assign_sorted(values.begin(), values.end());
+    fragile::copies_left = 50;
+    thrown = false;
+    try {
+      const cxx::rb_tree<fragile> copy { t };
+    } catch ( const std::runtime_error& ) {
+      thrown = true;
+    }
+    assert(thrown);
+
+    cxx::rb_tree<fragile> assigned;
+    fragile::copies_left = 50;
+    thrown = false;
+    try {
+      assigned = t;
+    } catch ( const std::runtime_error& ) {
+      thrown = true;
+    }
+    assert(thrown && assigned.empty());
+    fragile::copies_left = -1;
+  }
+
+  void test_nan_is_rejected_as_equivalent() {
+    // NaN is ordered neither before nor after anything, so it is equivalent to the
+    // first node it meets and must be rejected, never linked in over a child
+    cxx::rb_tree<double> t;
+    for ( int i = 0; i < 16; ++i ) {
+      t.insert(i);
+    }
+    assert(!t.insert(NAN).second);
+    assert(t.size() == 16);
+
+    double expected = 0;
+    t.scan([&expected](double v) { assert(v == expected); ++expected; });
+    assert(expected == 16);
+  }
+
+} // namespace
+
+int main() {
+  test_insert_keeps_balance();
+  test_search();
+  test_copy_clones_shape();
+  test_assign_sorted();
+  test_throwing_copy_does_not_leak();
+  test_nan_is_rejected_as_equivalent();
+  std::puts("rb_tree_test: OK");
+  return 0;
+}
@@ -0,0 +1,210 @@
+#include <atomic>     // For std::atomic
+#include <cassert>    // For assert
+#include <cstddef>    // For std::size_t
+#include <cstdio>     // For std::puts
+#include <stdexcept>  // For std::runtime_error
+#include <thread>     // For std::thread
+#include <vector>     // For std::vector
+
+#include "sharded_rb_tree.h"  // For cxx::sharded_rb_tree
+
+namespace {
+
+  using sharded = cxx::sharded_rb_tree<int>;
+
+  std::vector<int> collect(const sharded& t) {
+    std::vector<int> values;
+    t.scan([&values](int v) { values.push_back(v); });
+    return values;
+  }
+
+  void test_routing_and_lookup() {
+    sharded t { { 100, 200, 300 } };
+    assert(t.shard_count() == 4 && t.empty());
+
+    for ( int v : { 5, 100, 150, 299, 300, 1000 } ) {
+      assert(t.insert(v));
+    }
+    assert(!t.insert(150));
+    assert(t.size() == 6);
+    assert(t.contains(100) && t.contains(1000) && !t.contains(101));
+
+    // Crosses the empty remainder of the owning shard
+    assert(*t.lower_bound(6) == 100);
+    assert(*t.lower_bound(151) == 299);
+    assert(*t.lower_bound(-50) == 5);
+    assert(!t.lower_bound(1001).has_value());
+  }
+
+  void test_ordered_scans() {
+    sharded t { { 100, 200, 300 } };
+    for ( int v = 400; v >= 0; v -= 10 ) {
+      t.insert(v);
+    }
+
+    const std::vector<int> all = collect(t);
+    assert(all.size() == 41);
+    for ( std::size_t i = 0; i < all.size(); ++i ) {
+      assert(all[i] == static_cast<int>(i) * 10);
+    }
+
+    std::vector<int> seen;
+    t.scan(95, 215, [&seen](int v) { seen.push_back(v); });
+    assert((seen == std::vector<int> { 100, 110, 120, 130, 140, 150, 160, 170, 180, 190, 200, 210 }));
+
+    seen.clear();
+    t.scan(300, 300, [&seen](int v) { seen.push_back(v); });
+    t.scan(250, 120, [&seen](int v) { seen.push_back(v); });
+    assert(seen.empty());
+  }
+
+  void test_callback_may_use_the_container() {
+    sharded t { { 10 } };
+    t.insert(1);
+    t.insert(20);
+    // Callbacks run without shard locks held, inserting from one does not deadlock.
+    // Values inserted into shards not yet visited are seen by the same scan.
+    t.scan([&t](int v) {
+      if ( v < 1000 ) {
+        t.insert(v + 1000);
+      }
+    });
+    assert(t.size() == 4 && t.contains(1001) && t.contains(1020));
+  }
+
+  void test_rebalance() {
+    sharded t { { 10, 20, 30 } };
+    for ( int v = 1000; v < 1400; ++v ) {
+      t.insert(v);
+    }
+
+    t.rebalance();
+    const std::vector<int> bounds = t.boundaries();
+    assert((bounds == std::vector<int> { 1100, 1200, 1300 }));
+    assert(t.size() == 400);
+
+    const std::vector<int> all = collect(t);
+    assert(all.size() == 400 && all.front() == 1000 && all.back() == 1399);
+    assert(t.contains(1250) && *t.lower_bound(1199) == 1199);
+    assert(t.insert(5) && *t.lower_bound(0) == 5);
+
+    // Too few values to split, boundaries stay
+    sharded small { { 1, 2, 3 } };
+    small.insert(7);
+    small.rebalance();
+    assert((small.boundaries() == std::vector<int> { 1, 2, 3 }));
+  }
+
+  /// @brief Value whose copy throws once `poison_copies` copies of the `poison` value were made.
+  struct fragile
+  {
+    static inline bool armed         = false;
+    static inline int  poison        = 0;
+    static inline int  poison_copies = 0;
+
+    int _v;
+
+    explicit fragile(int v) : _v { v } { }
+
+    fragile(const fragile& other) : _v { other._v } {
+      if ( armed && _v == poison && poison_copies-- == 0 ) {
+        throw std::runtime_error("copy failed");
+      }
+    }
+
+    fragile(fragile&&) noexcept = default;
+    fragile& operator=(const fragile&) = default;
+    fragile& operator=(fragile&&) noexcept = default;
+
+    bool operator<(const fragile& other) const noexcept {
+      return _v < other._v;
+    }
+  };
+
+  void test_throwing_rebalance_changes_nothing() {
+    cxx::sharded_rb_tree<fragile> t { { fragile { -3 }, fragile { -2 }, fragile { -1 } } };
+    for ( int v = 0; v < 400; ++v ) {
+      t.insert(fragile { v });
+    }
+
+    // 350 is copied once when the values are collected, the copy into the last new shard throws
+    fragile::armed         = true;
+    fragile::poison        = 350;
+    fragile::poison_copies = 1;
+    bool thrown = false;
+    try {
+      t.rebalance();
+    } catch ( const std::runtime_error& ) {
+      thrown = true;
+    }
+    fragile::armed = false;
+    assert(thrown);
+
+    // The first shards were built before the throw, none of them may have replaced a live shard
+    const std::vector<fragile> bounds = t.boundaries();
+    assert(bounds.size() == 3 && bounds[0]._v == -3 && bounds[2]._v == -1);
+    assert(t.size() == 400);
+    int expected = 0;
+    t.scan([&expected](const fragile& f) { assert(f._v == expected++); });
+    assert(expected == 400 && t.contains(fragile { 150 }));
+
+    t.rebalance();
+    assert(t.boundaries()[1]._v == 200 && t.size() == 400 && t.contains(fragile { 150 }));
+  }
+
+  void test_concurrent_writers_and_rebalance() {
+    constexpr int writers   = 4;
+    constexpr int per_write = 5000;
+
+    // All values start in the last shard, rebalance has to spread them while writes continue
+    sharded t { { -3, -2, -1 } };
+    std::atomic<bool> done { false };
+
+    std::thread balancer([&t, &done] {
+      while ( !done.load() ) {
+        t.rebalance();
+        std::vector<int> values;
+        t.scan([&values](int v) { values.push_back(v); });
+        for ( std::size_t i = 1; i < values.size(); ++i ) {
+          assert(values[i - 1] < values[i]);
+        }
+        std::this_thread::yield();
+      }
+    });
+
+    std::vector<std::thread> pool;
+    for ( int id = 0; id < writers; ++id ) {
+      pool.emplace_back([&t, id] {
+        for ( int i = 0; i < per_write; ++i ) {
+          const int v = i * writers + id;
+          assert(t.insert(v));
+          assert(t.contains(v));
+          assert(*t.lower_bound(v) == v);
+        }
+      });
+    }
+    for ( std::thread& th : pool ) {
+      th.join();
+    }
+    done.store(true);
+    balancer.join();
+
+    const std::vector<int> all = collect(t);
+    assert(all.size() == writers * per_write);
+    for ( std::size_t i = 0; i < all.size(); ++i ) {
+      assert(all[i] == static_cast<int>(i));
+    }
+  }
+
+} // namespace
+
+int main() {
+  test_routing_and_lookup();
+  test_ordered_scans();
+  test_callback_may_use_the_container();
+  test_rebalance();
+  test_throwing_rebalance_changes_nothing();
+  test_concurrent_writers_and_rebalance();
+  std::puts("sharded_rb_tree_test: OK");
+  return 0;
+}